@@ -1,5 +1,7 @@
 #include <iostream>
 #include <string>
+#include <chrono>
+#include <limits>
 
 // Platform-specific includes for UTF-8 console support
 #ifdef _WIN32
@@ -25,6 +27,14 @@ int movesSinceCaptureOrPawn = 0;
 string moveHistory[1000];  // For threefold repetition
 int historyIndex = 0;
 
+// Chess clock (all times in milliseconds, 0 base time = untimed game)
+long long baseTimeMs = 0;
+long long incrementMs = 0;
+int movesPerControl = 0;  // 0 = whole game is one time control
+long long whiteTimeMs = 0, blackTimeMs = 0;
+int whiteMovesMade = 0, blackMovesMade = 0;
+chrono::steady_clock::time_point turnStart;
+
 void initBoard() {
     // Black pieces (uppercase)
     board[0][0] = 'R'; board[0][1] = 'N'; board[0][2] = 'B'; board[0][3] = 'Q';
@@ -438,7 +448,196 @@ bool isInsufficientMaterial() {
     return false;
 }
 
-void makeMove(int fromRow, int fromCol, int toRow, int toCol) {
+// Whether the winner could still mate by some legal sequence after the loser's flag falls
+bool canWinOnTime(bool winnerWhite) {
+    int winnerPieces = 0, winnerMinors = 0;
+    int loserPieces = 0;
+    int lightBishops = 0, darkBishops = 0;
+    bool onlyBishops = true;
+    
+    for(int i = 0; i < 8; i++) {
+        for(int j = 0; j < 8; j++) {
+            char piece = board[i][j];
+            if(piece == '.') continue;
+            
+            char p = (piece >= 'a' && piece <= 'z') ? piece - 32 : piece;
+            if(p == 'K') continue;  // Kings don't count
+            
+            if(isWhite(piece) == winnerWhite) {
+                winnerPieces++;
+                if(p == 'B' || p == 'N') winnerMinors++;
+            } else {
+                loserPieces++;
+            }
+            
+            if(p == 'B') {
+                if((i + j) % 2 == 0) darkBishops++;
+                else lightBishops++;
+            } else {
+                onlyBishops = false;
+            }
+        }
+    }
+    
+    // A bare king can never mate
+    if(winnerPieces == 0) return false;
+    
+    // A lone minor piece cannot mate a bare king
+    if(winnerPieces == 1 && winnerMinors == 1 && loserPieces == 0) return false;
+    
+    // Bishops that all share one square color can never mate
+    if(onlyBishops && (lightBishops == 0 || darkBishops == 0)) return false;
+    
+    return true;
+}
+
+// Prompts until 0 or a value from minValue to maxValue (a whole one if requested) is entered.
+// The range is checked before any cast so huge inputs cannot overflow.
+double readClockSetting(const string &prompt, double minValue, double maxValue, bool wholeNumber) {
+    double value;
+    while(true) {
+        cout << prompt;
+        if(cin >> value && (value == 0 || (value >= minValue && value <= maxValue)) &&
+           (!wholeNumber || value == (long long)value))
+            return value;
+        if(cin.eof()) return 0;
+        
+        // Discard the rest of the bad line so it isn't read as a move
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Invalid value! Please enter 0 or a " << (wholeNumber ? "whole number" : "number")
+             << " from " << minValue << " to " << maxValue << ".\n";
+    }
+}
+
+void initClock() {
+    double minutes = readClockSetting("Time control in minutes (0 for untimed): ", 0.1, 600, false);
+    if(minutes == 0) {
+        baseTimeMs = 0;
+        return;
+    }
+    double incSeconds = readClockSetting("Increment per move in seconds: ", 0.1, 600, false);
+    movesPerControl = (int)readClockSetting("Moves per time control (0 for whole game): ", 1, 200, true);
+    
+    baseTimeMs = (long long)(minutes * 60000);
+    incrementMs = (long long)(incSeconds * 1000);
+    whiteTimeMs = blackTimeMs = baseTimeMs;
+}
+
+// Splits the remaining time into a soft budget (the target for this move) and a
+// hard budget (a sensible upper bound). Both are advice for the player only;
+// nothing enforces them. Without a move quota, assume 30 moves remain.
+void allocateBudget(long long remaining, long long increment, int movesToGo,
+                    long long &softMs, long long &hardMs) {
+    if(movesToGo <= 0) movesToGo = 30;
+    
+    // Keep a small reserve so the clock is never run down to zero
+    long long usable = remaining - min(remaining / 20, 1000LL);
+    if(usable < 0) usable = 0;
+    
+    long long share = usable / movesToGo;
+    softMs = share + increment * 3 / 4;
+    hardMs = min(usable, share * 3 + increment);
+    
+    // On the last move before the control, aim for half so the bound stays above the target
+    if(movesToGo == 1) softMs = usable / 2;
+    if(softMs > hardMs) softMs = hardMs;
+}
+
+long long elapsedThisTurn() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now() - turnStart).count();
+}
+
+string formatTime(long long ms) {
+    if(ms < 0) ms = 0;
+    long long totalSeconds = ms / 1000;
+    string minutes = to_string(totalSeconds / 60);
+    string seconds = to_string(totalSeconds % 60);
+    if(seconds.length() < 2) seconds = "0" + seconds;
+    return minutes + ":" + seconds;
+}
+
+void printClock() {
+    if(baseTimeMs == 0) return;
+    
+    // Show the running side's clock as it stands right now
+    long long whiteShown = whiteTimeMs - (whiteTurn ? elapsedThisTurn() : 0);
+    long long blackShown = blackTimeMs - (whiteTurn ? 0 : elapsedThisTurn());
+    cout << "White " << formatTime(whiteShown) << "  |  Black " << formatTime(blackShown);
+    
+    // Advisory think time for the side to move, based on its clock at the start of the turn
+    int movesMade = whiteTurn ? whiteMovesMade : blackMovesMade;
+    int movesToGo = movesPerControl > 0 ? movesPerControl - movesMade % movesPerControl : 0;
+    long long softMs, hardMs;
+    allocateBudget(whiteTurn ? whiteTimeMs : blackTimeMs, incrementMs, movesToGo, softMs, hardMs);
+    cout << "  (advice: aim for " << formatTime(softMs) << ", try not to pass " << formatTime(hardMs) << ")\n";
+}
+
+bool flagFell(bool white) {
+    if(baseTimeMs == 0) return false;
+    return elapsedThisTurn() >= (white ? whiteTimeMs : blackTimeMs);
+}
+
+void announceTimeLoss(bool loserWhite) {
+    cout << (loserWhite ? "White" : "Black") << " ran out of time! ";
+    if(canWinOnTime(!loserWhite))
+        cout << (loserWhite ? "Black" : "White") << " wins on time!\n";
+    else
+        cout << "Draw by insufficient material to win on time!\n";
+}
+
+// Charges the mover for the whole turn, including any promotion prompt.
+// Returns false if the flag fell before the move was entered.
+bool punchClock(bool white) {
+    if(baseTimeMs == 0) return true;
+    
+    long long &remaining = white ? whiteTimeMs : blackTimeMs;
+    int &movesMade = white ? whiteMovesMade : blackMovesMade;
+    
+    remaining -= elapsedThisTurn();
+    if(remaining <= 0) {
+        remaining = 0;
+        return false;
+    }
+    
+    movesMade++;
+    remaining += incrementMs;
+    // Reaching the move quota starts a new time control
+    if(movesPerControl > 0 && movesMade % movesPerControl == 0)
+        remaining += baseTimeMs;
+    return true;
+}
+
+bool isPromotion(int fromRow, int fromCol, int toRow) {
+    char piece = board[fromRow][fromCol];
+    return (piece == 'p' || piece == 'P') && (toRow == 0 || toRow == 7);
+}
+
+char askPromotion() {
+    char promo;
+    bool validPromo = false;
+    
+    do {
+        cout << "Promote to (Q/R/B/N): ";
+        cin >> promo;
+        // Clear input buffer
+        while(cin.get() != '\n');
+        
+        if(promo >= 'a' && promo <= 'z') promo -= 32;
+        
+        if(promo == 'Q' || promo == 'R' || promo == 'B' || promo == 'N') {
+            validPromo = true;
+        } else {
+            cout << "Invalid choice! Please enter Q, R, B, or N.\n";
+        }
+    } while(!validPromo);
+    
+    return promo;
+}
+
+// promo is the promotion piece (Q/R/B/N); '.' asks the player if the move promotes
+void makeMove(int fromRow, int fromCol, int toRow, int toCol, char promo = '.') {
     char piece = board[fromRow][fromCol];
     char p = (piece >= 'a' && piece <= 'z') ? piece - 32 : piece;
     bool pieceIsWhite = isWhite(piece);
@@ -534,24 +733,7 @@ void makeMove(int fromRow, int fromCol, int toRow, int toCol) {
     
     // Pawn promotion
     if(p == 'P' && (toRow == 0 || toRow == 7)) {
-        char promo;
-        bool validPromo = false;
-        
-        do {
-            cout << "Promote to (Q/R/B/N): ";
-            cin >> promo;
-            // Clear input buffer
-            while(cin.get() != '\n');
-            
-            if(promo >= 'a' && promo <= 'z') promo -= 32;
-            
-            if(promo == 'Q' || promo == 'R' || promo == 'B' || promo == 'N') {
-                validPromo = true;
-            } else {
-                cout << "Invalid choice! Please enter Q, R, B, or N.\n";
-            }
-        } while(!validPromo);
-        
+        if(promo == '.') promo = askPromotion();
         board[toRow][toCol] = pieceIsWhite ? (promo + 32) : promo;
         movesSinceCaptureOrPawn = 0;  // Promotion is a pawn move
     }
@@ -580,8 +762,12 @@ int main() {
     cout << "Enter moves as: e2 e4\n";
     cout << "════════════════════════════════════════\n";
     
+    initClock();
+    turnStart = chrono::steady_clock::now();
+    
     while(true) {
         printBoard();
+        printClock();
         
         // Check for draws first
         if(isThreefoldRepetition()) {
@@ -614,7 +800,16 @@ int main() {
         string from, to;
         cin >> from >> to;
         
-        // Check for draw offer
+        // The flag is checked before any input is handled, so illegal or
+        // malformed moves cannot be used to play on after time has run out
+        if(flagFell(whiteTurn)) {
+            if(whiteTurn) whiteTimeMs = 0; else blackTimeMs = 0;
+            announceTimeLoss(whiteTurn);
+            break;
+        }
+        
+        // Check for draw offer. The clock of the side offering keeps running
+        // while the opponent decides, as there is only one clock per turn.
         if(from == "draw" || to == "draw") {
             cout << "Draw offered. Accept? (y/n): ";
             char response;
@@ -644,7 +839,17 @@ int main() {
         }
         
         if(isValidMove(fromRow, fromCol, toRow, toCol)) {
-            makeMove(fromRow, fromCol, toRow, toCol);
+            char promo = '.';
+            if(isPromotion(fromRow, fromCol, toRow)) promo = askPromotion();
+            
+            // Charged before the move is applied, so promotion time counts against
+            // the mover and a flag that falls at the prompt leaves the board untouched
+            if(!punchClock(whiteTurn)) {
+                announceTimeLoss(whiteTurn);
+                break;
+            }
+            makeMove(fromRow, fromCol, toRow, toCol, promo);
+            turnStart = chrono::steady_clock::now();
         } else {
             cout << "Illegal move! Try again.\n";
         }